@@ -2,7 +2,10 @@
 
 #include <boost/assert.hpp>
 
-RealType KnotCollection::KnotCurve::Value(Date const& d){
+#include <algorithm>
+
+template<class T>
+T BasicKnotCollection<T>::KnotCurve::Value(Date const& d){
         // one of four cases
         //    A) d is before all knots, then we just return the first rate
         //    B) d is after all knots, then we just return the last rate
@@ -33,12 +36,12 @@ RealType KnotCollection::KnotCurve::Value(Date const& d){
                         BOOST_ASSERT( d <= lu.upper->date );
                         BOOST_ASSERT( lu.lower->date <= d );
 
-                        double a = lu.upper->date - d;
-                        double b = lu.upper->date - lu.lower->date;
+                        T a = lu.upper->date - d;
+                        T b = lu.upper->date - lu.lower->date;
 
 
                         //auto intrp = lu.lower->value * a / b + lu.upper->value * ( 1.0 - a/b );
-                        auto intrp = std::exp(std::log(lu.lower->value) * a / b + std::log(lu.upper->value) * ( 1.0 - a/b ));
+                        T intrp = std::exp(std::log(lu.lower->value) * a / b + std::log(lu.upper->value) * ( T(1.0) - a/b ));
 
                         return intrp;
                 }
@@ -49,3 +52,84 @@ RealType KnotCollection::KnotCurve::Value(Date const& d){
 
 
 }
+
+template<class T>
+typename BasicKnotCollection<T>::Knot& BasicKnotCollection<T>::KnotCurve::Controlling(Date const& d){
+        auto lu = LowerUpperBound(d);
+        if( ! lu.lower && ! lu.upper )
+                throw std::domain_error("no knots!");
+        if( ! lu.lower )
+                return *lu.upper;
+        if( ! lu.upper )
+                return *lu.lower;
+        // the interpolation weight is highest on the nearer knot
+        if( d - lu.lower->date < lu.upper->date - d )
+                return *lu.lower;
+        return *lu.upper;
+}
+
+template<class T>
+typename BasicKnotCollection<T>::KnotCurve& BasicKnotCollection<T>::KnotCurve::Pin(Date const& d, T value){
+        for(auto& k : Rng()){
+                if( k.date == d ){
+                        k.value = value;
+                        return *this;
+                }
+        }
+        throw std::domain_error("not a knot!");
+}
+
+template<class T>
+BasicVectorType<T> BasicKnotCollection<T>::KnotCurve::Values(std::vector<Date> const& dates){
+        using ArrayType = Eigen::Array<T, Eigen::Dynamic, 1>;
+
+        std::vector<Date> knot_dates;
+        std::vector<T>    knot_log_values;
+        for(auto const& k : Rng()){
+                knot_dates.push_back(k.date);
+                knot_log_values.push_back(std::log(k.value));
+        }
+        if( knot_dates.empty() )
+                throw std::domain_error("no knots!");
+
+        // first pass is the search, which can't be vectorized, so we
+        // just reduce each date to a pair of log values and a weight,
+        // with the flat extrapolation being a zero weight
+        ArrayType lower(dates.size());
+        ArrayType upper(dates.size());
+        ArrayType w(dates.size());
+        for(size_t idx=0;idx!=dates.size();++idx){
+                auto const& d = dates[idx];
+                size_t hi = std::upper_bound(knot_dates.begin(), knot_dates.end(), d) - knot_dates.begin();
+                if( hi == 0 ){
+                        lower(idx) = upper(idx) = knot_log_values.front();
+                        w(idx) = 0.0;
+                } else if( hi == knot_dates.size() ){
+                        lower(idx) = upper(idx) = knot_log_values.back();
+                        w(idx) = 0.0;
+                } else {
+                        size_t lo = hi - 1;
+                        lower(idx) = knot_log_values[lo];
+                        upper(idx) = knot_log_values[hi];
+                        w(idx) = T( d - knot_dates[lo] ) / T( knot_dates[hi] - knot_dates[lo] );
+                }
+        }
+
+        // second pass is the same interpolation as Value()
+        BasicVectorType<T> ret = ( lower * ( T(1.0) - w ) + upper * w ).exp().matrix();
+        return ret;
+}
+
+#define KNOTS_INSTANTIATE(T)                                                                         \
+        template T                  BasicKnotCollection<T>::KnotCurve::Value(Date const&);            \
+        template typename BasicKnotCollection<T>::Knot&                                              \
+                                    BasicKnotCollection<T>::KnotCurve::Controlling(Date const&);      \
+        template typename BasicKnotCollection<T>::KnotCurve&                                         \
+                                    BasicKnotCollection<T>::KnotCurve::Pin(Date const&, T);           \
+        template BasicVectorType<T> BasicKnotCollection<T>::KnotCurve::Values(std::vector<Date> const&);
+
+KNOTS_INSTANTIATE(float)
+KNOTS_INSTANTIATE(double)
+KNOTS_INSTANTIATE(long double)
+
+#undef KNOTS_INSTANTIATE
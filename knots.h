@@ -32,10 +32,23 @@ using namespace QuantLib;
 // this is important
 using RealType = double;
 
-using MatrixType = Eigen::Matrix<RealType, Eigen::Dynamic, Eigen::Dynamic>;
-using VectorType = Eigen::Matrix<RealType, Eigen::Dynamic, 1>; 
-
-inline std::string ToString(VectorType const& V){
+/*
+        Everything below is templated on the scalar type, so that a
+        solved curve can be evaluated in float for twice the SIMD width,
+        whilst the Jacobian/linear solve runs in double or long double.
+        The only conversion point is BasicKnotCollection::Cast<U>(),
+        the unqualified names are the RealType instantiations
+ */
+template<class T>
+using BasicMatrixType = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+template<class T>
+using BasicVectorType = Eigen::Matrix<T, Eigen::Dynamic, 1>; 
+
+using MatrixType = BasicMatrixType<RealType>;
+using VectorType = BasicVectorType<RealType>; 
+
+template<class T>
+inline std::string ToString(BasicVectorType<T> const& V){
         std::stringstream sstr;
         sstr << std::fixed;
         sstr << "<" << V.size() << ">";
@@ -47,9 +60,10 @@ inline std::string ToString(VectorType const& V){
         return sstr.str();
 }
 
-struct Knot{
+template<class T>
+struct BasicKnot{
 
-        Knot(std::string const& curve_, Date date_, RealType value_)
+        BasicKnot(std::string const& curve_, Date date_, T value_)
                 :curve(curve_),
                 date(date_),
                 value(value_)
@@ -57,12 +71,15 @@ struct Knot{
 
         std::string curve;
         Date date;
-        RealType value;
+        T value;
 };
 
 
 
-struct KnotCollection : std::vector<Knot>{
+template<class T>
+struct BasicKnotCollection : std::vector<BasicKnot<T> >{
+
+        using Knot = BasicKnot<T>;
                 
         using KnotRange = boost::any_range<
                 Knot,
@@ -73,7 +90,7 @@ struct KnotCollection : std::vector<Knot>{
 
 
         struct KnotCurve{
-                KnotCurve(KnotCollection* collection, std::string const& curve)
+                KnotCurve(BasicKnotCollection* collection, std::string const& curve)
                         :collection_(collection),
                         curve_(curve)
                 {}
@@ -84,11 +101,11 @@ struct KnotCollection : std::vector<Knot>{
                         return *collection_ | boost::adaptors::filtered([&](auto&& k){ return k.curve == curve_; });
                 }
 
-                KnotCurve& Add(Date const& d, RealType value = 1.0){
+                KnotCurve& Add(Date const& d, T value = 1.0){
                         collection_->emplace_back(curve_, d, value);
                         return *this;
                 }
-                KnotCurve& Fill(RealType val){
+                KnotCurve& Fill(T val){
                         for(auto& _ : Rng()){
                                 _.value = val;
                         }
@@ -97,7 +114,28 @@ struct KnotCollection : std::vector<Knot>{
 
 
 
-                RealType Value(Date const& d);
+                T Value(Date const& d);
+
+                /*
+                        The knot that Value(d) moves with the most, ie
+                        the nearer of the two either side of d, or the
+                        end knot outside the curve
+                 */
+                Knot& Controlling(Date const& d);
+                /*
+                        Sets the knot on d, so that Value(d) == value. It
+                        doesn't invert the interpolation, as that blows up
+                        when d is just after the lower knot
+                 */
+                KnotCurve& Pin(Date const& d, T value);
+
+                /*
+                        Batch version of Value(), same interpolation and
+                        extrapolation rules, but the knots are copied out
+                        once and the interpolation is done as a single
+                        Eigen array expression so it vectorizes
+                 */
+                BasicVectorType<T> Values(std::vector<Date> const& dates);
 
                 enum LowerUpperBoundCategory{
                         LUB_NotAnInterval,
@@ -145,9 +183,9 @@ struct KnotCollection : std::vector<Knot>{
                         return false;
                 }
 
-                VectorType AsVector(){
+                BasicVectorType<T> AsVector(){
 
-                        VectorType ret(0);
+                        BasicVectorType<T> ret(0);
                         size_t idx =0 ;
                         for(auto const& k : Rng()){
                                 ret.resize(idx+1);
@@ -165,7 +203,7 @@ struct KnotCollection : std::vector<Knot>{
                 }
 
         private:
-                KnotCollection* collection_;
+                BasicKnotCollection* collection_;
                 std::string curve_;
         };
 
@@ -174,10 +212,22 @@ struct KnotCollection : std::vector<Knot>{
                 return KnotCurve{this, name};
         }
         
-        VectorType AsVector()const{
-                VectorType ret(size());
-                for(size_t idx=0;idx!=size();++idx){
-                        ret(idx) = at(idx).value;
+        BasicVectorType<T> AsVector()const{
+                BasicVectorType<T> ret(this->size());
+                for(size_t idx=0;idx!=this->size();++idx){
+                        ret(idx) = this->at(idx).value;
+                }
+                return ret;
+        }
+
+        template<class U>
+        BasicKnotCollection<U> Cast()const{
+                BasicKnotCollection<U> ret;
+                for(auto const& name : names_){
+                        ret.Curve(name);
+                }
+                for(auto const& k : *this){
+                        ret.emplace_back(k.curve, k.date, static_cast<U>(k.value));
                 }
                 return ret;
         }
@@ -185,15 +235,19 @@ private:
         std::unordered_set<std::string> names_;
 };
 
-inline RealType RateFromDfCurve(KnotCollection& V,
-                                Date const& start,
-                                Date const& end,
-                                std::string const& curve)
+using Knot           = BasicKnot<RealType>;
+using KnotCollection = BasicKnotCollection<RealType>;
+
+template<class T>
+inline T RateFromDfCurve(BasicKnotCollection<T>& V,
+                         Date const& start,
+                         Date const& end,
+                         std::string const& curve)
 {
-        RealType start_df = V.Curve(curve).Value( start );
-        RealType end_df   = V.Curve(curve).Value( end );
-        RealType yf = ( end - start ) / 365.0;
-        RealType implied_rate = ( start_df / end_df - 1.0 ) / yf;
+        T start_df = V.Curve(curve).Value( start );
+        T end_df   = V.Curve(curve).Value( end );
+        T yf = ( end - start ) / T(365.0);
+        T implied_rate = ( start_df / end_df - T(1.0) ) / yf;
         return implied_rate;
 }
 
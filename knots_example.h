@@ -0,0 +1,92 @@
+#ifndef KNOTS_EXAMPLE_H
+#define KNOTS_EXAMPLE_H
+
+#include "knots.h"
+#include "knots_solver.h"
+#include "knots_residue.h"
+#include "knots_fixed_solver.h"
+
+/*
+        The OIS and 3 month curve from the README, pulled out of the
+        driver so the benchmarks solve exactly the same system.
+        ExampleKnots() is the original hand listed layout, the driver
+        now derives its knots with KnotPlanner
+ */
+template<class T>
+void ExampleKnots(BasicKnotCollection<T>& C){
+        
+        // this represents the knot points of the ois curve
+        auto oisdf = C.Curve("oisdf");
+        oisdf.Add(Date(2, Feb, 2016));
+        oisdf.Add(Date(2, Aug, 2016));
+        oisdf.Add(Date(2, Feb, 2017));
+        oisdf.Add(Date(2, Feb, 2018));
+        oisdf.Add(Date(2, Feb, 2019));
+        oisdf.Add(Date(2, Feb, 2021));
+        oisdf.Add(Date(2, Feb, 2023));
+        oisdf.Add(Date(2, Feb, 2026));
+
+        auto m3df = C.Curve("3mdf");
+
+        // this represents the knot points of the 3 month curve
+        m3df.Add(Date( 2, Feb, 2016));
+
+        m3df.Add(Date( 2, May, 2016));
+        m3df.Add(Date(15, Jun, 2016));
+        m3df.Add(Date(14, Sep, 2016));
+        m3df.Add(Date(14, Dec, 2016));
+
+        m3df.Add(Date(15, Mar, 2017));
+        m3df.Add(Date(14, Jun, 2017));
+        m3df.Add(Date(13, Sep, 2017));
+        m3df.Add(Date(13, Dec, 2017));
+        
+        m3df.Add(Date(14, Mar, 2018));
+        m3df.Add(Date( 2, Feb, 2019));
+        m3df.Add(Date( 2, Feb, 2021));
+        m3df.Add(Date( 2, Feb, 2023));
+        m3df.Add(Date( 2, Feb, 2026));
+}
+
+/*
+        The instruments as a tuple, so the same set can go to either
+        BasicKnotSolver or BasicFixedKnotSolver
+ */
+template<class T>
+auto ExampleResidues(){
+        return std::make_tuple(
+                BasicConstant<T>(Date(2 ,Feb,2016), 1.0, "3mdf"),
+                BasicConstant<T>(Date(2 ,Feb,2016), 1.0, "oisdf"),
+
+                BasicFraRate<T>(Date( 2,Feb,2016), 1.00, "3mdf"),
+                BasicFraRate<T>(Date(16,Mar,2016), 1.05, "3mdf"),
+                BasicFraRate<T>(Date(15,Jun,2016), 1.12, "3mdf"),
+                BasicFraRate<T>(Date(14,Sep,2016), 1.16, "3mdf"),
+                BasicFraRate<T>(Date(14,Dec,2016), 1.21, "3mdf"),
+
+                BasicFraRate<T>(Date(15,Mar,2017), 1.27, "3mdf"),
+                BasicFraRate<T>(Date(14,Jun,2017), 1.45, "3mdf"),
+                BasicFraRate<T>(Date(13,Sep,2017), 1.68, "3mdf"),
+                BasicFraRate<T>(Date(13,Dec,2017), 1.92, "3mdf"),
+
+                BasicSwapRate<T>(Date(2,Feb,2016), 1.68, 3 * 4, "3mdf"),
+                BasicSwapRate<T>(Date(2,Feb,2016), 2.1 , 5 * 4, "3mdf"),
+                BasicSwapRate<T>(Date(2,Feb,2016), 2.2 , 7 * 4, "3mdf"),
+                BasicSwapRate<T>(Date(2,Feb,2016), 2.07,10 * 4, "3mdf"),
+
+                BasicOisSwapRate<T>(Date(2,Feb,2016), 0.18, 2),
+                BasicOisSwapRate<T>(Date(2,Feb,2016), 0.20, 1*4),
+                BasicOisSwapRate<T>(Date(2,Feb,2016), 0.17, 2*4),
+                BasicOisSwapRate<T>(Date(2,Feb,2016), 0.15, 3*4),
+                BasicOisSwapRate<T>(Date(2,Feb,2016), 0.11, 5*4),
+                BasicOisSwapRate<T>(Date(2,Feb,2016), 0.10, 7*4),
+                BasicOisSwapRate<T>(Date(2,Feb,2016), 0.09,10*4)
+        );
+}
+
+template<class T>
+void ExampleInstruments(BasicKnotSolver<T>& S){
+        AddResidues(S, ExampleResidues<T>());
+}
+
+#endif // KNOTS_EXAMPLE_H
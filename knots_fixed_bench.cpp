@@ -0,0 +1,54 @@
+#include "knots.h"
+#include "knots_solver.h"
+#include "knots_residue.h"
+#include "knots_planner.h"
+#include "knots_fixed_solver.h"
+#include "knots_example.h"
+
+#include <boost/timer/timer.hpp>
+#include <boost/log/expressions.hpp>
+
+/*
+        BasicKnotSolver against BasicFixedKnotSolver on the README
+        system, both starting from the seeded KnotPlanner layout, as
+        the driver does
+ */
+int main(){
+        boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::warning);
+        std::cout << std::scientific;
+
+        enum{ Repeat = 10 };
+
+        KnotSolver S;
+        ExampleInstruments(S);
+        S.SetDebug(false);
+
+        auto plan = KnotPlanner(S).Make();
+        if( ! plan.IsSquare() ){
+                plan.Display();
+        }
+        KnotCollection C = S.Seed(plan.knots);
+
+        auto residues = ExampleResidues<RealType>();
+
+        KnotCollection dynamic_sol;
+        boost::timer::cpu_timer dynamic_timer;
+        for(size_t iter=0;iter!=Repeat;++iter){
+                dynamic_sol = S.Solve(C);
+        }
+        dynamic_timer.stop();
+
+        KnotCollection fixed_sol;
+        boost::timer::cpu_timer fixed_timer;
+        for(size_t iter=0;iter!=Repeat;++iter){
+                fixed_sol = SolveFixed(C, residues);
+        }
+        fixed_timer.stop();
+
+        RealType max_diff = ( dynamic_sol.AsVector() - fixed_sol.AsVector() ).cwiseAbs().maxCoeff();
+
+        std::cout << "knots = " << C.size() << ", residues = " << std::tuple_size<decltype(residues)>::value << "\n";
+        std::cout << "solve dynamic: " << dynamic_timer.elapsed().wall / 1e6 / Repeat << "ms\n";
+        std::cout << "solve fixed: "   << fixed_timer.elapsed().wall / 1e6 / Repeat   << "ms\n";
+        std::cout << "max knot diff: " << max_diff                                   << "\n";
+}
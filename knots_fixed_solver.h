@@ -0,0 +1,285 @@
+#ifndef KNOTS_FIXED_SOLVER_H
+#define KNOTS_FIXED_SOLVER_H
+
+#include "knots_solver.h"
+
+#include <array>
+#include <tuple>
+#include <utility>
+
+/*
+        Above this the fixed size matrices are too big for the stack,
+        and JacobiSVD is slower than the dynamic BDCSVD anyway
+ */
+enum{ MaxFixedKnots = 32 };
+
+/*
+        Same Gauss-Newton iteration as BasicKnotSolver::Solve(), but for
+        systems where the knot count, residue count and residue types
+        are known at compile time. The matrices are fixed size so live
+        on the stack, the residues are held by value in a std::tuple,
+        and priced through their non virtual Price().
+
+        The knot layout is fixed at construction, where every residue
+        dependency is resolved to a pair of knot indices and weights,
+        so the Jacobian loop works on a std::array of knot values
+        without any curve lookups or allocation.
+
+        This is header only, as the instantiations depend on the
+        residue types of the caller
+ */
+template<class T, int Knots, class... Residues>
+struct BasicFixedKnotSolver{
+
+        enum{
+                NumKnots    = Knots,
+                NumResidues = sizeof...(Residues),
+        };
+        static_assert( Knots <= MaxFixedKnots && sizeof...(Residues) <= MaxFixedKnots,
+                       "too big for the fixed solver, use BasicKnotSolver");
+
+        using CollectionType = BasicKnotCollection<T>;
+        using KnotArrayType  = std::array<T, NumKnots>;
+        using JacobianType   = Eigen::Matrix<T, NumResidues, NumKnots>;
+        using NormalType     = Eigen::Matrix<T, NumKnots, NumKnots>;
+        using ResidueType    = Eigen::Matrix<T, NumResidues, 1>;
+        using KnotVectorType = Eigen::Matrix<T, NumKnots, 1>;
+
+        BasicFixedKnotSolver(CollectionType const& layout, Residues const&... res)
+                :BasicFixedKnotSolver(layout, std::make_tuple(res...))
+        {}
+        BasicFixedKnotSolver(CollectionType const& layout, std::tuple<Residues...> const& res)
+                :layout_(layout),
+                res_(res)
+        {
+                if( layout_.size() != NumKnots )
+                        throw std::domain_error("knot count doesn't match the fixed solver");
+                ResolveImpl(std::index_sequence_for<Residues...>{});
+        }
+
+        ResidueType CalcResidue(KnotArrayType const& values, KnotArrayType const& logs)const{
+                return CalcResidueImpl(values, logs, std::index_sequence_for<Residues...>{});
+        }
+        JacobianType NumericalJacobian(KnotArrayType& values, KnotArrayType& logs)const{
+                const T epsilon = 1e-10;
+
+                // bump in place rather than copying the knots per column
+                JacobianType J;
+                for(size_t i=0;i!=NumKnots;++i){
+                        T value = values[i];
+                        T log_value = logs[i];
+                        values[i] = value + epsilon / 2;
+                        logs[i] = std::log(values[i]);
+                        ResidueType upper = CalcResidue(values, logs);
+                        values[i] = value - epsilon / 2;
+                        logs[i] = std::log(values[i]);
+                        ResidueType lower = CalcResidue(values, logs);
+                        values[i] = value;
+                        logs[i] = log_value;
+                        J.col(i) = ( upper - lower ) / epsilon;
+                }
+
+                return J;
+        }
+        CollectionType Solve(CollectionType k)const{
+
+                if( k.size() != NumKnots )
+                        throw std::domain_error("knot count doesn't match the fixed solver");
+                for(size_t idx=0;idx!=NumKnots;++idx){
+                        if( k[idx].curve != layout_[idx].curve || k[idx].date != layout_[idx].date )
+                                throw std::domain_error("knots don't match the fixed solver layout");
+                }
+
+                KnotArrayType values;
+                KnotArrayType logs;
+                for(size_t idx=0;idx!=NumKnots;++idx){
+                        values[idx] = k[idx].value;
+                        logs[idx] = std::log(values[idx]);
+                }
+
+                enum{ MaxIter = 1000 };
+                for(size_t iter=0;iter < MaxIter;++iter){
+                        JacobianType J = NumericalJacobian(values, logs);
+                        ResidueType F = CalcResidue(values, logs);
+
+                        NormalType A = J.transpose() * J;
+                        KnotVectorType B = - J.transpose() * F;
+
+                        using namespace Eigen;
+                        // thin U/V aren't available for fixed sizes, A is square anyway
+                        KnotVectorType sol = A.jacobiSvd(ComputeFullU | ComputeFullV).solve(B);
+
+                        // same step rule as BasicKnotSolver::Solve()
+                        T alpha = F.template lpNorm<Eigen::Infinity>() < T(1e-2) ? T(1.0) : T(0.5);
+                        for(size_t idx=0;idx!=NumKnots;++idx){
+                                values[idx] += alpha * sol(idx);
+                                logs[idx] = std::log(values[idx]);
+                        }
+
+                        if( sol.template lpNorm<2>() < 1e-5 ){
+                                for(size_t idx=0;idx!=NumKnots;++idx){
+                                        k[idx].value = values[idx];
+                                }
+                                return k;
+                        }
+                }
+
+                std::cerr << "Failed to converge\n";
+                std::exit(1);
+                return k;
+        }
+private:
+        /*
+                A dependency of a residue, as the knots either side of
+                it. When lower == upper the point is on, or flat
+                extrapolated from, that knot, otherwise it's the log
+                linear interpolation KnotCurve::Value() does
+         */
+        struct Stencil{
+                size_t lower;
+                size_t upper;
+                T lower_weight;
+                T upper_weight;
+        };
+        struct Lookup{
+                KnotArrayType const& values;
+                KnotArrayType const& logs;
+                std::vector<Stencil> const& stencils;
+
+                T operator()(size_t idx)const{
+                        auto const& s = stencils[idx];
+                        if( s.lower == s.upper )
+                                return values[s.lower];
+                        return std::exp(logs[s.lower] * s.lower_weight + logs[s.upper] * s.upper_weight);
+                }
+        };
+
+        // same search as KnotCurve::LowerUpperBound()
+        Stencil Resolve(KnotPoint const& p)const{
+                boost::optional<size_t> lower;
+                boost::optional<size_t> upper;
+                for(size_t idx=0;idx!=NumKnots;++idx){
+                        auto const& k = layout_[idx];
+                        if( k.curve != p.curve )
+                                continue;
+                        if( k.date <= p.date ){
+                                lower = idx;
+                        }
+                        if( p.date <= k.date ){
+                                upper = idx;
+                                break;
+                        }
+                }
+                if( ! lower && ! upper )
+                        throw std::domain_error("no knots!");
+                if( ! lower )
+                        return Stencil{*upper, *upper, T(0.0), T(1.0)};
+                if( ! upper )
+                        return Stencil{*lower, *lower, T(1.0), T(0.0)};
+                if( *lower == *upper )
+                        return Stencil{*lower, *lower, T(1.0), T(0.0)};
+
+                T a = layout_[*upper].date - p.date;
+                T b = layout_[*upper].date - layout_[*lower].date;
+                return Stencil{*lower, *upper, a / b, T(1.0) - a / b};
+        }
+        template<size_t... I>
+        void ResolveImpl(std::index_sequence<I...>){
+                int dummy[] = { 0, ( ResolveOne(std::get<I>(res_), stencils_[I]), 0 )... };
+                (void)dummy;
+        }
+        template<class R>
+        void ResolveOne(R const& r, std::vector<Stencil>& stencils)const{
+                for(auto const& p : r.Dependencies()){
+                        stencils.push_back(Resolve(p));
+                }
+        }
+        template<size_t... I>
+        ResidueType CalcResidueImpl(KnotArrayType const& values, KnotArrayType const& logs, std::index_sequence<I...>)const{
+                ResidueType ret;
+                int dummy[] = { 0, ( ret(I) = std::get<I>(res_).Price(Lookup{values, logs, stencils_[I]}), 0 )... };
+                (void)dummy;
+                return ret;
+        }
+
+        CollectionType layout_;
+        std::tuple<Residues...> res_;
+        std::array<std::vector<Stencil>, NumResidues> stencils_;
+};
+
+/*
+        Bridge back to the dynamic solver, for the shapes which
+        don't have a fixed instantiation
+ */
+template<class T, class... Residues, size_t... I>
+void AddResiduesImpl(BasicKnotSolver<T>& S, std::tuple<Residues...> const& res, std::index_sequence<I...>){
+        int dummy[] = { 0, ( S.template Add<Residues>(std::get<I>(res)), 0 )... };
+        (void)dummy;
+}
+template<class T, class... Residues>
+void AddResidues(BasicKnotSolver<T>& S, std::tuple<Residues...> const& res){
+        AddResiduesImpl(S, res, std::index_sequence_for<Residues...>{});
+}
+
+/*
+        The knot counts to instantiate BasicFixedKnotSolver for, shapes
+        over MaxFixedKnots are skipped rather than instantiated
+ */
+template<int... Knots>
+struct FixedKnotShapes{};
+
+using DefaultFixedKnotShapes = FixedKnotShapes<8, 12, 16, 22, 24, 32>;
+
+template<int... Knots>
+struct FixedKnotDispatch;
+
+template<>
+struct FixedKnotDispatch<>{
+        template<class T, class... Residues>
+        static bool Solve(BasicKnotCollection<T>& k, std::tuple<Residues...> const& res){
+                return false;
+        }
+};
+
+template<int K, int... Rest>
+struct FixedKnotDispatch<K, Rest...>{
+        template<class T, class... Residues>
+        static bool Solve(BasicKnotCollection<T>& k, std::tuple<Residues...> const& res){
+                using Fits = std::integral_constant<bool, K <= MaxFixedKnots && sizeof...(Residues) <= MaxFixedKnots>;
+                if( k.size() == K && SolveIf(Fits{}, k, res) )
+                        return true;
+                return FixedKnotDispatch<Rest...>::Solve(k, res);
+        }
+private:
+        template<class T, class... Residues>
+        static bool SolveIf(std::true_type, BasicKnotCollection<T>& k, std::tuple<Residues...> const& res){
+                k = BasicFixedKnotSolver<T, K, Residues...>(k, res).Solve(k);
+                return true;
+        }
+        template<class T, class... Residues>
+        static bool SolveIf(std::false_type, BasicKnotCollection<T>& k, std::tuple<Residues...> const& res){
+                return false;
+        }
+};
+
+/*
+        Picks the fixed size instantiation matching the runtime knot
+        count, falling back to BasicKnotSolver when there isn't one,
+        or the system is over MaxFixedKnots
+ */
+template<class T, class... Residues, int... Knots>
+BasicKnotCollection<T> SolveFixed(FixedKnotShapes<Knots...>, BasicKnotCollection<T> k, std::tuple<Residues...> const& res){
+        if( FixedKnotDispatch<Knots...>::Solve(k, res) )
+                return k;
+
+        BasicKnotSolver<T> S;
+        S.SetDebug(false);
+        AddResidues(S, res);
+        return S.Solve(k);
+}
+template<class T, class... Residues>
+BasicKnotCollection<T> SolveFixed(BasicKnotCollection<T> k, std::tuple<Residues...> const& res){
+        return SolveFixed(DefaultFixedKnotShapes{}, std::move(k), res);
+}
+
+#endif // KNOTS_FIXED_SOLVER_H
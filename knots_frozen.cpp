@@ -0,0 +1,68 @@
+#include "knots_frozen.h"
+
+#include <algorithm>
+
+template<class T>
+BasicFrozenCurve<T>::BasicFrozenCurve(BasicKnotCollection<T>& C,
+                                      std::string const& curve,
+                                      Date const& first,
+                                      Date const& last,
+                                      bool forwards)
+        :curve_(curve),
+        first_(first),
+        forwards_(forwards)
+{
+        if( last < first )
+                throw std::domain_error("empty range");
+        for(Date iter=first;iter<=last;++iter){
+                dates_.push_back(iter);
+                if( forwards_ )
+                        end_dates_.push_back(iter + Period(3, Months));
+        }
+        Rebuild(C);
+}
+
+template<class T>
+BasicFrozenCurve<T>& BasicFrozenCurve<T>::Rebuild(BasicKnotCollection<T>& C){
+
+        // Rng() filters on the KnotCurve, so it has to outlive the loop
+        auto solved = C.Curve(curve_);
+
+        knot_dates_.clear();
+        knot_log_values_.clear();
+        for(auto const& k : solved.Rng()){
+                knot_dates_.push_back(k.date);
+                knot_log_values_.push_back(std::log(k.value));
+        }
+        if( knot_dates_.empty() )
+                throw std::domain_error("no knots!");
+
+        df_ = solved.Values(dates_);
+
+        if( forwards_ ){
+                BasicVectorType<T> end_df = solved.Values(end_dates_);
+                fwd_.resize(dates_.size());
+                for(size_t idx=0;idx!=dates_.size();++idx){
+                        T yf = ( end_dates_[idx] - dates_[idx] ) / T(365.0);
+                        fwd_[idx] = ( df_[idx] / end_df[idx] - T(1.0) ) / yf;
+                }
+        }
+        return *this;
+}
+
+template<class T>
+T BasicFrozenCurve<T>::Extrapolate(Date const& d)const{
+        // same as KnotCurve::Value(), flat outside the knots, log linear between
+        size_t hi = std::upper_bound(knot_dates_.begin(), knot_dates_.end(), d) - knot_dates_.begin();
+        if( hi == 0 )
+                return std::exp(knot_log_values_.front());
+        if( hi == knot_dates_.size() )
+                return std::exp(knot_log_values_.back());
+        size_t lo = hi - 1;
+        T w = T( d - knot_dates_[lo] ) / T( knot_dates_[hi] - knot_dates_[lo] );
+        return std::exp(knot_log_values_[lo] * ( T(1.0) - w ) + knot_log_values_[hi] * w);
+}
+
+template struct BasicFrozenCurve<float>;
+template struct BasicFrozenCurve<double>;
+template struct BasicFrozenCurve<long double>;
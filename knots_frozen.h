@@ -0,0 +1,72 @@
+#ifndef KNOTS_FROZEN_H
+#define KNOTS_FROZEN_H
+
+#include "knots.h"
+
+/*
+        Read only view of one curve of a solved collection, with the
+        discount factors (and optionally the 3 month forward rates) for
+        every day in [first,last] materialised into an array indexed by
+        serial number. Lookups inside the range are a subtraction and a
+        load, outside the range they fall back to a copy of the knot
+        dates and log values, with the same extrapolation rules as
+        KnotCurve::Value(). Nothing is modified after Rebuild(), so one
+        view can be shared between threads.
+
+        The dates are fixed at construction, so Rebuild() after each
+        solve is just one KnotCurve::Values() batch per array
+ */
+template<class T>
+struct BasicFrozenCurve{
+
+        BasicFrozenCurve(BasicKnotCollection<T>& C,
+                         std::string const& curve,
+                         Date const& first,
+                         Date const& last,
+                         bool forwards = false);
+
+        BasicFrozenCurve& Rebuild(BasicKnotCollection<T>& C);
+
+        std::string Name()const{ return curve_; }
+        Date First()const{ return first_; }
+        Date Last()const{ return first_ + static_cast<BigInteger>(dates_.size()) - 1; }
+
+        T Value(Date const& d)const{
+                // unsigned, so dates before first_ wrap round and fail too
+                size_t idx = static_cast<size_t>( d.serialNumber() - first_.serialNumber() );
+                if( idx < static_cast<size_t>(df_.size()) )
+                        return df_[idx];
+                return Extrapolate(d);
+        }
+        /*
+                Same as RateFromDfCurve(C, d, d + 3M, curve), only
+                available when built with forwards
+         */
+        T Forward(Date const& d)const{
+                size_t idx = static_cast<size_t>( d.serialNumber() - first_.serialNumber() );
+                if( idx < static_cast<size_t>(fwd_.size()) )
+                        return fwd_[idx];
+                if( ! forwards_ )
+                        throw std::domain_error("frozen curve was built without forwards");
+                Date end = d + Period(3, Months);
+                T yf = ( end - d ) / T(365.0);
+                return ( Extrapolate(d) / Extrapolate(end) - T(1.0) ) / yf;
+        }
+private:
+        std::string curve_;
+        Date first_;
+        bool forwards_;
+        std::vector<Date> dates_;
+        std::vector<Date> end_dates_;
+        BasicVectorType<T> df_;
+        BasicVectorType<T> fwd_;
+        // only used out of range
+        std::vector<Date> knot_dates_;
+        std::vector<T> knot_log_values_;
+
+        T Extrapolate(Date const& d)const;
+};
+
+using FrozenCurve = BasicFrozenCurve<RealType>;
+
+#endif // KNOTS_FROZEN_H
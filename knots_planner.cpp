@@ -0,0 +1,89 @@
+#include "knots_planner.h"
+
+#include <map>
+#include <algorithm>
+
+#include <boost/lexical_cast.hpp>
+
+template<class T>
+void BasicKnotPlanner<T>::Plan::Display()const{
+        std::cout << "=========plan=========\n";
+        std::cout << "knots = " << knots.size() << ", residues = " << residues << "\n";
+        for(auto const& _ : issues){
+                std::cout << ( _.kind == Issue_OverDetermined ? "over-determined " : "under-determined " )
+                          << _.curve << " " << _.date << " : " << _.what << "\n";
+        }
+        std::cout << "==================================\n";
+}
+
+template<class T>
+typename BasicKnotPlanner<T>::Plan BasicKnotPlanner<T>::Make()const{
+
+        Plan plan;
+        plan.residues = solver_->Residues().size();
+
+        // keep the curves in the order they're first pinned, so the
+        // layout is stable with respect to the instrument order
+        std::vector<std::string> curves;
+        std::map<std::string, std::vector<Date> > pillars;
+        std::map<std::string, std::vector<Date> > reads;
+
+        for(auto const& r : solver_->Residues()){
+                auto p = r->Pillar();
+                if( pillars.count(p.curve) == 0 )
+                        curves.push_back(p.curve);
+                pillars[p.curve].push_back(p.date);
+                for(auto const& d : r->Dependencies()){
+                        reads[d.curve].push_back(d.date);
+                }
+        }
+
+        for(auto const& _ : reads){
+                if( pillars.count(_.first) == 0 ){
+                        auto first = *std::min_element(_.second.begin(), _.second.end());
+                        plan.issues.push_back(Issue{Issue_UnderDetermined, _.first, first, "curve is read but no residue pins it"});
+                }
+        }
+
+        for(auto const& name : curves){
+                auto& dates = pillars[name];
+                std::sort(dates.begin(), dates.end());
+
+                std::vector<Date> knots;
+                for(auto const& d : dates){
+                        if( knots.size() && d - knots.back() < min_spacing_ ){
+                                std::string what = ( d == knots.back() ? "pillar shared with another residue"
+                                                                       : "pillar merged into knot at " + boost::lexical_cast<std::string>(knots.back()) );
+                                plan.issues.push_back(Issue{Issue_OverDetermined, name, d, what});
+                                continue;
+                        }
+                        knots.push_back(d);
+                }
+
+                // a knot only moves Value() strictly between its
+                // neighbours, so some residue has to read in there
+                auto const& r = reads[name];
+                for(size_t idx=0;idx!=knots.size();++idx){
+                        bool read = std::any_of(r.begin(), r.end(), [&](Date const& d){
+                                if( idx != 0 && d <= knots[idx-1] )
+                                        return false;
+                                if( idx+1 != knots.size() && knots[idx+1] <= d )
+                                        return false;
+                                return true;
+                        });
+                        if( ! read ){
+                                plan.issues.push_back(Issue{Issue_UnderDetermined, name, knots[idx], "no residue reads around this knot"});
+                        }
+                }
+
+                auto curve = plan.knots.Curve(name);
+                for(auto const& d : knots){
+                        curve.Add(d);
+                }
+        }
+
+        return plan;
+}
+
+template struct BasicKnotPlanner<double>;
+template struct BasicKnotPlanner<long double>;
@@ -0,0 +1,56 @@
+#ifndef KNOTS_PLANNER_H
+#define KNOTS_PLANNER_H
+
+#include "knots_solver.h"
+
+/*
+        Derives the knot layout from the residues registered on a
+        solver, rather than listing knots by hand. Every residue gets
+        one knot at its pillar, so when nothing is flagged the system
+        is square. Pillars on the same curve closer than min_spacing
+        days share a knot, as two knots a few days apart only make
+        J^T J worse conditioned.
+
+        The plan flags
+                over-determined,  more than one residue pinning a knot
+                under-determined, a curve that is read but never pinned,
+                                  or a knot that no residue reads around
+ */
+template<class T>
+struct BasicKnotPlanner{
+
+        enum IssueKind{
+                Issue_OverDetermined,
+                Issue_UnderDetermined,
+        };
+        struct Issue{
+                IssueKind kind;
+                std::string curve;
+                Date date;
+                std::string what;
+        };
+        struct Plan{
+                BasicKnotCollection<T> knots;
+                std::vector<Issue> issues;
+                size_t residues = 0;
+
+                bool IsSquare()const{
+                        return issues.empty() && knots.size() == residues;
+                }
+                void Display()const;
+        };
+
+        explicit BasicKnotPlanner(BasicKnotSolver<T> const& solver, BigInteger min_spacing = 7)
+                :solver_(&solver),
+                min_spacing_(min_spacing)
+        {}
+
+        Plan Make()const;
+private:
+        BasicKnotSolver<T> const* solver_;
+        BigInteger min_spacing_;
+};
+
+using KnotPlanner = BasicKnotPlanner<RealType>;
+
+#endif // KNOTS_PLANNER_H
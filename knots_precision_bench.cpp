@@ -0,0 +1,84 @@
+#include "knots.h"
+#include "knots_solver.h"
+#include "knots_residue.h"
+#include "knots_example.h"
+
+#include <boost/timer/timer.hpp>
+#include <boost/log/expressions.hpp>
+
+/*
+        Throughput vs accuracy of the precision split, ie
+                solve in double or long double,
+                evaluate in float, double or long double
+        against the long double solve evaluated in long double
+ */
+
+template<class T>
+BasicKnotCollection<T> SolveExample(){
+        BasicKnotCollection<T> C;
+        BasicKnotSolver<T> S;
+        ExampleKnots(C);
+        ExampleInstruments(S);
+        S.SetDebug(false);
+        return S.Solve(C);
+}
+
+template<class T, class U>
+void BenchmarkLookup(char const* name,
+                     BasicKnotCollection<U> const& solved,
+                     std::vector<Date> const& dates,
+                     BasicVectorType<long double> const& reference,
+                     size_t repeat)
+{
+        auto C = solved.template Cast<T>();
+        auto curve = C.Curve("3mdf");
+
+        BasicVectorType<T> values;
+        boost::timer::cpu_timer timer;
+        for(size_t iter=0;iter!=repeat;++iter){
+                values = curve.Values(dates);
+        }
+        timer.stop();
+
+        double ms = timer.elapsed().wall / 1e6;
+        double lookups = static_cast<double>(dates.size()) * repeat;
+        long double max_diff = ( values.template cast<long double>() - reference ).cwiseAbs().maxCoeff();
+
+        std::cout << name << ": "
+                  << ms << "ms, "
+                  << ( lookups / ms * 1e3 ) << " lookups/s, "
+                  << "max df diff " << static_cast<double>(max_diff) << "\n";
+}
+
+int main(){
+        boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::warning);
+        std::cout << std::scientific;
+
+        enum{ Repeat = 1000 };
+
+        boost::timer::cpu_timer double_timer;
+        auto double_sol = SolveExample<double>();
+        double_timer.stop();
+
+        boost::timer::cpu_timer long_double_timer;
+        auto long_double_sol = SolveExample<long double>();
+        long_double_timer.stop();
+
+        long double max_knot_diff = ( double_sol.AsVector().template cast<long double>() - long_double_sol.AsVector() ).cwiseAbs().maxCoeff();
+
+        std::cout << "solve double: "      << double_timer.elapsed().wall / 1e6      << "ms\n";
+        std::cout << "solve long double: " << long_double_timer.elapsed().wall / 1e6 << "ms\n";
+        std::cout << "max knot diff: "     << static_cast<double>(max_knot_diff)    << "\n";
+
+        std::vector<Date> dates;
+        for(Date iter(2,Feb,2016);iter<=Date(2,Nov,2025);++iter){
+                dates.push_back(iter);
+        }
+
+        auto reference = long_double_sol.Curve("3mdf").Values(dates);
+
+        BenchmarkLookup<float>      ("double solve, float lookup",            double_sol,      dates, reference, Repeat);
+        BenchmarkLookup<double>     ("double solve, double lookup",           double_sol,      dates, reference, Repeat);
+        BenchmarkLookup<float>      ("long double solve, float lookup",       long_double_sol, dates, reference, Repeat);
+        BenchmarkLookup<long double>("long double solve, long double lookup", long_double_sol, dates, reference, Repeat);
+}
@@ -0,0 +1,217 @@
+#include "knots.h"
+#include "knots_solver.h"
+#include "knots_residue.h"
+#include "knots_planner.h"
+#include "knots_frozen.h"
+
+#include <ql/settings.hpp>
+#include <ql/currencies/europe.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+
+#include <boost/timer/timer.hpp>
+#include <boost/log/expressions.hpp>
+
+/*
+        Head to head against QuantLib's PiecewiseYieldCurve, on an
+        instrument set that both sides price identically
+                oisdf, simple deposits from spot         RateBetween / DepositRateHelper
+                3mdf,  3 month FRAs over the first 2y    FraRate     / FraRateHelper
+                3mdf,  annual swaps discounted on oisdf  SwapRate    / SwapRateHelper
+        everything is Act/365, unadjusted, with no settlement lag, and
+        both sides interpolate log linearly on discount factors.
+        QuantLib bootstraps the two curves one after the other, whilst
+        KnotSolver solves them at once.
+
+        The OisSwapRate basis quotes from the README example aren't
+        used, as there's no helper that prices them the same way
+ */
+
+struct Quotes{
+        std::vector<std::pair<Period, Rate> > deposits;
+        // months to start
+        std::vector<std::pair<Natural, Rate> > fras;
+        // years to maturity
+        std::vector<std::pair<Natural, Rate> > swaps;
+};
+
+Quotes MakeQuotes(Natural years){
+        auto ois = [](double t){ return 0.0010 + 0.0008 * t; };
+
+        Quotes q;
+        for(Natural m : {3, 6, 9}){
+                q.deposits.emplace_back(Period(m, Months), ois(m / 12.0));
+        }
+        for(Natural y=1;y<=years;++y){
+                q.deposits.emplace_back(Period(y, Years), ois(y));
+        }
+        for(Natural m=0;m<24;m+=3){
+                q.fras.emplace_back(m, ois(m / 12.0) + 0.0020);
+        }
+        for(Natural y=3;y<=years;++y){
+                q.swaps.emplace_back(y, ois(y) + 0.0025);
+        }
+        return q;
+}
+
+KnotCollection BuildKnotSolver(Date const& spot, Quotes const& q){
+        KnotSolver S;
+        S.SetDebug(false);
+
+        S.Add<Constant>(spot, 1.0, "oisdf");
+        S.Add<Constant>(spot, 1.0, "3mdf");
+
+        for(auto const& _ : q.deposits){
+                S.Add<RateBetween>(spot, spot + _.first, _.second * 100.0, "oisdf");
+        }
+        for(auto const& _ : q.fras){
+                S.Add<FraRate>(spot + Period(_.first, Months), _.second * 100.0, "3mdf");
+        }
+        for(auto const& _ : q.swaps){
+                S.Add<SwapRate>(spot, _.second * 100.0, _.first * 4, "3mdf");
+        }
+
+        auto plan = KnotPlanner(S).Make();
+        if( ! plan.IsSquare() ){
+                plan.Display();
+        }
+        return S.Solve(S.Seed(plan.knots));
+}
+
+struct QuantLibCurves{
+        ext::shared_ptr<YieldTermStructure> ois;
+        ext::shared_ptr<YieldTermStructure> m3;
+};
+
+QuantLibCurves BuildQuantLib(Date const& spot, Quotes const& q){
+        using CurveType = PiecewiseYieldCurve<Discount, LogLinear>;
+
+        Settings::instance().evaluationDate() = spot;
+
+        Calendar cal = NullCalendar();
+        DayCounter dc = Actual365Fixed();
+
+        QuantLibCurves curves;
+
+        std::vector<ext::shared_ptr<RateHelper> > ois_helpers;
+        for(auto const& _ : q.deposits){
+                ois_helpers.push_back(ext::shared_ptr<RateHelper>(
+                        new DepositRateHelper(_.second, _.first, 0, cal, Unadjusted, false, dc)));
+        }
+        curves.ois = ext::shared_ptr<YieldTermStructure>(new CurveType(spot, ois_helpers, dc));
+
+        ext::shared_ptr<IborIndex> index(new IborIndex("3M", Period(3, Months), 0, EURCurrency(), cal, Unadjusted, false, dc));
+        Handle<YieldTermStructure> discounting(curves.ois);
+
+        std::vector<ext::shared_ptr<RateHelper> > m3_helpers;
+        for(auto const& _ : q.fras){
+                m3_helpers.push_back(ext::shared_ptr<RateHelper>(
+                        new FraRateHelper(_.second, _.first, index)));
+        }
+        for(auto const& _ : q.swaps){
+                m3_helpers.push_back(ext::shared_ptr<RateHelper>(
+                        new SwapRateHelper(_.second, Period(_.first, Years), cal, Quarterly, Unadjusted, dc,
+                                           index, Handle<Quote>(), 0 * Days, discounting)));
+        }
+        curves.m3 = ext::shared_ptr<YieldTermStructure>(new CurveType(spot, m3_helpers, dc));
+
+        // the curves are lazy, so force the bootstrap
+        curves.m3->discount(spot + Period(1, Days));
+        return curves;
+}
+
+int main(){
+        boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::warning);
+        std::cout << std::scientific;
+
+        enum{ Repeat = 100 };
+        const double Tolerance = 1e-4;
+
+        Date spot(2, Feb, 2016);
+        bool ok = true;
+        double sink = 0.0;
+
+        for(Natural years : {5, 10, 20}){
+                auto q = MakeQuotes(years);
+
+                boost::timer::cpu_timer knot_build_timer;
+                auto sol = BuildKnotSolver(spot, q);
+                knot_build_timer.stop();
+
+                boost::timer::cpu_timer ql_build_timer;
+                auto curves = BuildQuantLib(spot, q);
+                ql_build_timer.stop();
+
+                std::vector<Date> dates;
+                for(Date iter=spot;iter<=spot + Period(years, Years);++iter){
+                        dates.push_back(iter);
+                }
+
+                double max_diff = 0.0;
+                for(auto const& d : dates){
+                        max_diff = std::max(max_diff, std::fabs(sol.Curve("oisdf").Value(d) - curves.ois->discount(d)));
+                        max_diff = std::max(max_diff, std::fabs(sol.Curve("3mdf").Value(d)  - curves.m3->discount(d)));
+                }
+
+                auto m3 = sol.Curve("3mdf");
+
+                boost::timer::cpu_timer knot_lookup_timer;
+                for(size_t iter=0;iter!=Repeat;++iter){
+                        for(auto const& d : dates){
+                                sink += m3.Value(d);
+                        }
+                }
+                knot_lookup_timer.stop();
+
+                boost::timer::cpu_timer knot_batch_timer;
+                for(size_t iter=0;iter!=Repeat;++iter){
+                        sink += m3.Values(dates).sum();
+                }
+                knot_batch_timer.stop();
+
+                boost::timer::cpu_timer frozen_build_timer;
+                FrozenCurve frozen(sol, "3mdf", dates.front(), dates.back());
+                frozen_build_timer.stop();
+
+                boost::timer::cpu_timer frozen_lookup_timer;
+                for(size_t iter=0;iter!=Repeat;++iter){
+                        for(auto const& d : dates){
+                                sink += frozen.Value(d);
+                        }
+                }
+                frozen_lookup_timer.stop();
+
+                boost::timer::cpu_timer ql_lookup_timer;
+                for(size_t iter=0;iter!=Repeat;++iter){
+                        for(auto const& d : dates){
+                                sink += curves.m3->discount(d);
+                        }
+                }
+                ql_lookup_timer.stop();
+
+                double lookups = static_cast<double>(dates.size()) * Repeat;
+                auto throughput = [&](boost::timer::cpu_timer const& timer){
+                        return lookups / timer.elapsed().wall * 1e9;
+                };
+
+                std::cout << "=========" << years << "y, " << sol.size() << " knots=========\n";
+                std::cout << "build KnotSolver: "          << knot_build_timer.elapsed().wall / 1e6   << "ms\n";
+                std::cout << "build QuantLib: "            << ql_build_timer.elapsed().wall / 1e6     << "ms\n";
+                std::cout << "lookup KnotSolver: "         << throughput(knot_lookup_timer)           << " lookups/s\n";
+                std::cout << "lookup KnotSolver batched: " << throughput(knot_batch_timer)            << " lookups/s\n";
+                std::cout << "build FrozenCurve: "         << frozen_build_timer.elapsed().wall / 1e6 << "ms\n";
+                std::cout << "lookup FrozenCurve: "        << throughput(frozen_lookup_timer)         << " lookups/s\n";
+                std::cout << "lookup QuantLib: "           << throughput(ql_lookup_timer)             << " lookups/s\n";
+                std::cout << "max df diff: "               << max_diff                                << "\n";
+
+                if( max_diff > Tolerance ){
+                        std::cerr << "Failed to match QuantLib at " << years << "y\n";
+                        ok = false;
+                }
+        }
+
+        // keeps the lookup loops from being optimized away
+        std::cout << "sink = " << sink << "\n";
+
+        return ok ? 0 : 1;
+}
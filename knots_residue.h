@@ -3,204 +3,352 @@
 
 
 
-struct Constant : KnotSolver::Residue{
+/*
+        The accrual dates of a quarterly schedule, start followed by
+        one date per period. The swap residues price, pin and report
+        dependencies off the same schedule
+ */
+inline std::vector<Date> QuarterlySchedule(Date const& start, size_t periods){
+        std::vector<Date> ret{start};
+        Date iter = start;
+        for(size_t idx=0;idx!=periods;++idx){
+                iter += Period(3, Months);
+                ret.push_back(iter);
+        }
+        return ret;
+}
+
+/*
+        Each residue prices itself in Price(df), where df(idx) is the
+        discount factor at Dependencies()[idx]. Calc() reads those off
+        the collection through CollectionLookup, whilst
+        BasicFixedKnotSolver resolves them to knot indices once, so both
+        solvers share the one pricing formula
+ */
+template<class T>
+struct CollectionLookup{
+        BasicKnotCollection<T>& V;
+        std::vector<KnotPoint> const& points;
+        T operator()(size_t idx)const{
+                return V.Curve(points[idx].curve).Value(points[idx].date);
+        }
+};
+
+template<class T>
+struct BasicConstant : BasicKnotSolver<T>::Residue{
         enum{ Debug = 1 };
-        Constant(Date date, RealType target, std::string const& curve)
+        BasicConstant(Date date, T target, std::string const& curve)
                 :date_(date),
                 target_(target),
-                curve_(curve)
+                curve_(curve),
+                points_{ KnotPoint{curve_, date_} }
         {}
-        virtual RealType Calc(KnotCollection& V, bool debug)const{
-                RealType val = V.Curve(curve_).Value(date_);
-                RealType residue = std::fabs( val  - target_ );
-                SLOG(trace) << "Constant.residue=" << residue << ", val=" << val;
+        virtual T Calc(BasicKnotCollection<T>& V, bool debug)const{
+                T residue = Price(CollectionLookup<T>{V, points_});
+                SLOG(trace) << "Constant.residue=" << residue;
                 return residue;
         }
+        template<class DF>
+        T Price(DF const& df)const{
+                T val = df(0);
+                return std::fabs( val  - target_ );
+        }
+        virtual KnotPoint Pillar()const{
+                return KnotPoint{curve_, date_};
+        }
+        virtual std::vector<KnotPoint> Dependencies()const{
+                return points_;
+        }
+        virtual void Seed(BasicKnotCollection<T>& V)const{
+                if( ! V.Curve(curve_).IsKnot(date_) )
+                        return BasicKnotSolver<T>::Residue::Seed(V);
+                V.Curve(curve_).Pin(date_, target_);
+        }
 private:
         Date date_;
-        RealType target_;
+        T target_;
         std::string curve_;
+        std::vector<KnotPoint> points_;
 };
-struct RateBetween : KnotSolver::Residue{
-        RateBetween(Date start, Date end, RealType rate, std::string const& curve)
+template<class T>
+struct BasicRateBetween : BasicKnotSolver<T>::Residue{
+        BasicRateBetween(Date start, Date end, T rate, std::string const& curve)
                 :start_(start),
                 end_(end),
                 rate_(rate),
-                curve_(curve)
+                curve_(curve),
+                points_{ KnotPoint{curve_, start_}, KnotPoint{curve_, end_} }
         {}
-        virtual RealType Calc(KnotCollection& V, bool debug )const{
-                RealType start_df = V.Curve(curve_).Value( start_ );
-                RealType end_df   = V.Curve(curve_).Value( end_ );
+        virtual T Calc(BasicKnotCollection<T>& V, bool debug )const{
+                return Price(CollectionLookup<T>{V, points_});
+        }
+        template<class DF>
+        T Price(DF const& df)const{
+                T start_df = df(0);
+                T end_df   = df(1);
 
 
-                RealType val = ( start_df / end_df - 1.0 ) / (end_ - start_ ) * 365.0 * 100.0;
+                T val = ( start_df / end_df - T(1.0) ) / (end_ - start_ ) * T(365.0) * T(100.0);
 
-                RealType residue = std::fabs( val - rate_ );
+                T residue = std::fabs( val - rate_ );
 
                 return residue;
         }
+        virtual KnotPoint Pillar()const{
+                return KnotPoint{curve_, end_};
+        }
+        virtual std::vector<KnotPoint> Dependencies()const{
+                return points_;
+        }
+        virtual void Seed(BasicKnotCollection<T>& V)const{
+                if( ! V.Curve(curve_).IsKnot(end_) )
+                        return BasicKnotSolver<T>::Residue::Seed(V);
+                T start_df = V.Curve(curve_).Value( start_ );
+                T yf = ( end_ - start_ ) / T(365.0);
+                V.Curve(curve_).Pin(end_, start_df / ( T(1.0) + rate_ / T(100.0) * yf ));
+        }
 private:
         Date start_;
         Date end_;
-        RealType rate_;
+        T rate_;
         std::string curve_;
+        std::vector<KnotPoint> points_;
 };
-struct BasisDiff : KnotSolver::Residue{
-        BasisDiff(Date point, std::string const& left, std::string const& right, double basis)
+template<class T>
+struct BasicBasisDiff : BasicKnotSolver<T>::Residue{
+        BasicBasisDiff(Date point, std::string const& left, std::string const& right, T basis)
                 :point_(point),
                 left_(left),
                 right_(right),
-                basis_(basis)
+                basis_(basis),
+                points_{ KnotPoint{left_, point_}, KnotPoint{right_, point_} }
         {}
-        virtual RealType Calc(KnotCollection& V, bool debug )const{
-                auto A = V.Curve(left_).Value(point_);
-                auto B = V.Curve(right_).Value(point_);
-                auto val = ( A - B );
-                auto residue = std::fabs( val - basis_ );
+        virtual T Calc(BasicKnotCollection<T>& V, bool debug )const{
+                return Price(CollectionLookup<T>{V, points_});
+        }
+        template<class DF>
+        T Price(DF const& df)const{
+                T A = df(0);
+                T B = df(1);
+                T val = ( A - B );
+                T residue = std::fabs( val - basis_ );
                 return residue;
         }
+        virtual KnotPoint Pillar()const{
+                return KnotPoint{right_, point_};
+        }
+        virtual std::vector<KnotPoint> Dependencies()const{
+                return points_;
+        }
+        virtual void Seed(BasicKnotCollection<T>& V)const{
+                if( ! V.Curve(right_).IsKnot(point_) )
+                        return BasicKnotSolver<T>::Residue::Seed(V);
+                auto A = V.Curve(left_).Value(point_);
+                V.Curve(right_).Pin(point_, A - basis_);
+        }
 private:
         Date point_;
         std::string left_;
         std::string right_;
-        double basis_;
+        T basis_;
+        std::vector<KnotPoint> points_;
 };
-struct SwapRate : KnotSolver::Residue{
-        SwapRate(Date start, RealType rate, double periods, std::string const& curve)
-                :start_(start),
+template<class T>
+struct BasicSwapRate : BasicKnotSolver<T>::Residue{
+        BasicSwapRate(Date start, T rate, double periods, std::string const& curve)
+                :schedule_(QuarterlySchedule(start, periods)),
                 rate_(rate),
-                periods_(periods),
                 curve_(curve)
-        {}
-        virtual RealType Calc(KnotCollection& V, bool debug )const{
-
-                Period d(3, Months);
+        {
+                for(size_t idx=1;idx<schedule_.size();++idx){
+                        points_.push_back(KnotPoint{curve_, schedule_[idx-1]});
+                        points_.push_back(KnotPoint{curve_, schedule_[idx]});
+                        points_.push_back(KnotPoint{"oisdf", schedule_[idx]});
+                }
+        }
+        virtual T Calc(BasicKnotCollection<T>& V, bool debug )const{
+                return Price(CollectionLookup<T>{V, points_});
+        }
+        // three points per period, see the constructor
+        template<class DF>
+        T Price(DF const& df_at)const{
 
-                RealType nume = 0.0;
-                RealType deno = 0.0;
+                T nume = 0.0;
+                T deno = 0.0;
                 
-                Date iter = start_;
-                for(size_t idx=0;idx!=periods_;++idx){
-                        auto start = iter;
-                        auto end  =  iter + d;
-                        RealType yf = ( end - start ) / 365.0;
-                        RealType df = V.Curve("oisdf").Value(end);
+                for(size_t idx=1;idx<schedule_.size();++idx){
+                        size_t p = ( idx - 1 ) * 3;
+                        auto start = schedule_[idx-1];
+                        auto end   = schedule_[idx];
+                        T yf = ( end - start ) / T(365.0);
+                        T df = df_at(p + 2);
 
 
-                        RealType start_df = V.Curve(curve_).Value( start );
-                        RealType end_df   = V.Curve(curve_).Value( end );
+                        T start_df = df_at(p);
+                        T end_df   = df_at(p + 1);
 
 
-                        RealType ri = ( start_df / end_df - 1.0 ) / yf * 100.0;
+                        T ri = ( start_df / end_df - T(1.0) ) / yf * T(100.0);
 
                         nume += yf * ri * df;
                         deno += yf * df;
-
-                        iter += d;
                 }
 
-                RealType val = nume / deno;
+                T val = nume / deno;
 
-                RealType residue = std::fabs( val - rate_ );
+                T residue = std::fabs( val - rate_ );
 
                 return residue;
         }
+        virtual KnotPoint Pillar()const{
+                return KnotPoint{curve_, Maturity()};
+        }
+        virtual std::vector<KnotPoint> Dependencies()const{
+                return points_;
+        }
+        Date Maturity()const{
+                return schedule_.back();
+        }
 private:
-        Date start_;
-        RealType rate_;
-        double periods_;
+        std::vector<Date> schedule_;
+        T rate_;
         std::string curve_;
+        std::vector<KnotPoint> points_;
 };
 
-struct OisSwapRate : KnotSolver::Residue{
-        OisSwapRate(Date start, RealType rate, double periods)
-                :start_(start),
-                rate_(rate),
-                periods_(periods)
-        {}
-        virtual RealType Calc(KnotCollection& V, bool debug )const{
-
-                Period d(3, Months);
+template<class T>
+struct BasicOisSwapRate : BasicKnotSolver<T>::Residue{
+        BasicOisSwapRate(Date start, T rate, double periods)
+                :schedule_(QuarterlySchedule(start, periods)),
+                rate_(rate)
+        {
+                for(size_t idx=1;idx<schedule_.size();++idx){
+                        points_.push_back(KnotPoint{"3mdf", schedule_[idx-1]});
+                        points_.push_back(KnotPoint{"3mdf", schedule_[idx]});
+                        points_.push_back(KnotPoint{"oisdf", schedule_[idx-1]});
+                        points_.push_back(KnotPoint{"oisdf", schedule_[idx]});
+                }
+        }
+        virtual T Calc(BasicKnotCollection<T>& V, bool debug )const{
+                T residue = Price(CollectionLookup<T>{V, points_});
+                SLOG(trace) << "OisSwapRate.residue = " << residue;
+                return residue;
+        }
+        // four points per period, see the constructor
+        template<class DF>
+        T Price(DF const& df_at)const{
 
-                RealType m3_nume = 0.0;
-                RealType m3_deno = 0.0;
+                T m3_nume = 0.0;
+                T m3_deno = 0.0;
                 
-                RealType ois_nume = 0.0;
-                RealType ois_deno = 0.0;
+                T ois_nume = 0.0;
+                T ois_deno = 0.0;
                 
-                Date iter = start_;
-                for(size_t idx=0;idx!=periods_;++idx){
-                        auto start = iter;
-                        auto end  =  iter + d;
+                for(size_t idx=1;idx<schedule_.size();++idx){
+                        size_t p = ( idx - 1 ) * 4;
+                        auto start = schedule_[idx-1];
+                        auto end   = schedule_[idx];
         
-                        RealType yf = ( end - start ) / 365.0;
+                        T yf = ( end - start ) / T(365.0);
 
-                        auto m3rate  = RateFromDfCurve(V, start, end, "3mdf");
-                        auto oisrate = RateFromDfCurve(V, start, end, "oisdf");
+                        T m3rate  = ( df_at(p)     / df_at(p + 1) - T(1.0) ) / yf;
+                        T oisrate = ( df_at(p + 2) / df_at(p + 3) - T(1.0) ) / yf;
                         
-                        RealType df = V.Curve("oisdf").Value(end);
+                        T df = df_at(p + 3);
 
                         m3_nume += yf * m3rate * df;
                         m3_deno += yf * df;
                         
                         ois_nume += yf * oisrate * df;
                         ois_deno += yf * df;
-
-                        iter += d;
                 }
 
-                RealType m3_fixed = m3_nume / m3_deno;
-                RealType ois_fixed = ois_nume / ois_deno;
+                T m3_fixed = m3_nume / m3_deno;
+                T ois_fixed = ois_nume / ois_deno;
 
 
-                RealType basis = ( m3_fixed - ois_fixed ) * 100.0;
+                T basis = ( m3_fixed - ois_fixed ) * T(100.0);
 
-                SLOG(trace) << "m3_fixed = " << m3_fixed;
-                SLOG(trace) << "ois_fixed = " << ois_fixed;
-                SLOG(trace) << "basis = " << basis << "\n";
-                RealType residue = std::fabs( basis - rate_ );
+                T residue = std::fabs( basis - rate_ );
 
                 return residue;
         }
+        virtual KnotPoint Pillar()const{
+                return KnotPoint{"oisdf", Maturity()};
+        }
+        virtual std::vector<KnotPoint> Dependencies()const{
+                return points_;
+        }
+        Date Maturity()const{
+                return schedule_.back();
+        }
 private:
-        Date start_;
-        RealType rate_;
-        double periods_;
+        std::vector<Date> schedule_;
+        T rate_;
+        std::vector<KnotPoint> points_;
 };
-struct FraRate : KnotSolver::Residue{
+template<class T>
+struct BasicFraRate : BasicKnotSolver<T>::Residue{
         enum{ Debug =0 };
-        FraRate(Date d, RealType quote, std::string const& curve)
+        BasicFraRate(Date d, T quote, std::string const& curve)
                 :d_(d),
                 quote_(quote),
-                curve_(curve)
+                curve_(curve),
+                end_(d_ + Period(3, Months)),
+                points_{ KnotPoint{curve_, d_}, KnotPoint{curve_, end_} }
         {}
-        virtual RealType Calc(KnotCollection& V, bool debug )const{
-                static QuantLib::Period p(3, Months);
-                Date end = d_ + p;
-                RealType start_df = V.Curve(curve_).Value( d_ );
-                RealType end_df   = V.Curve(curve_).Value( end );
-
-
-                RealType rate = ( start_df / end_df - 1.0 ) / ( end - d_ ) * 365 * 100.0;
-
-                RealType residue = std::fabs( rate - quote_ );
+        virtual T Calc(BasicKnotCollection<T>& V, bool debug )const{
+                CollectionLookup<T> df{V, points_};
+                T residue = Price(df);
 
                 if( Debug || debug){
+                        T start_df = df(0);
+                        T end_df   = df(1);
                         std::cout << "---------------------\n";
                         std::cout << "quote_ = " << quote_ << "\n";
                         std::cout << "d_ = " << d_ << "\n";
-                        std::cout << "end = " << end << "\n";
+                        std::cout << "end = " << end_ << "\n";
                         std::cout << "start_df = " << start_df << "\n";
                         std::cout << "end_df = " << end_df << "\n";
-                        std::cout << "rate = " << rate << "\n";
+                        std::cout << "rate = " << ForwardRate(start_df, end_df) << "\n";
                         std::cout << "residue = " << residue << "\n";
                 }
                 return residue;
         }
+        template<class DF>
+        T Price(DF const& df)const{
+                return std::fabs( ForwardRate(df(0), df(1)) - quote_ );
+        }
+        virtual KnotPoint Pillar()const{
+                return KnotPoint{curve_, end_};
+        }
+        virtual std::vector<KnotPoint> Dependencies()const{
+                return points_;
+        }
+        virtual void Seed(BasicKnotCollection<T>& V)const{
+                if( ! V.Curve(curve_).IsKnot(end_) )
+                        return BasicKnotSolver<T>::Residue::Seed(V);
+                T start_df = V.Curve(curve_).Value( d_ );
+                T yf = ( end_ - d_ ) / T(365.0);
+                V.Curve(curve_).Pin(end_, start_df / ( T(1.0) + quote_ / T(100.0) * yf ));
+        }
 private:
+        T ForwardRate(T start_df, T end_df)const{
+                return ( start_df / end_df - T(1.0) ) / ( end_ - d_ ) * T(365.0) * T(100.0);
+        }
+
         Date d_;
-        RealType quote_;
+        T quote_;
         std::string curve_;
+        Date end_;
+        std::vector<KnotPoint> points_;
 };
 
+using Constant    = BasicConstant<RealType>;
+using RateBetween = BasicRateBetween<RealType>;
+using BasisDiff   = BasicBasisDiff<RealType>;
+using SwapRate    = BasicSwapRate<RealType>;
+using OisSwapRate = BasicOisSwapRate<RealType>;
+using FraRate     = BasicFraRate<RealType>;
+
 #endif // KNOTS_RESIDUE_H
@@ -1,8 +1,58 @@
 #include "knots_solver.h"
 
-KnotCollection KnotSolver::Solve(KnotCollection k){
+#include <algorithm>
 
-        enum{ Debug = 1 };
+template<class T>
+typename BasicKnotSolver<T>::CollectionType BasicKnotSolver<T>::Seed(CollectionType k)const{
+
+        enum{ MaxPasses = 10 };
+
+        std::vector<std::shared_ptr<Residue> > order = res_;
+        std::stable_sort(order.begin(), order.end(), [](auto const& l, auto const& r){
+                return l->Pillar().date < r->Pillar().date;
+        });
+
+        CollectionType initial = k;
+
+        std::vector<bool> seeded(k.size(), false);
+        for(auto const& r : order){
+                auto p = r->Pillar();
+                r->Seed(k);
+
+                auto const& knot = k.Curve(p.curve).Controlling(p.date);
+                for(size_t idx=0;idx!=k.size();++idx){
+                        if( &k[idx] == &knot ){
+                                seeded[idx] = true;
+                        } else if( ! seeded[idx] && k[idx].curve == knot.curve && knot.date < k[idx].date ){
+                                k[idx].value = knot.value;
+                        }
+                }
+        }
+
+        // a layout with knots away from the pillars can seed worse
+        // than the initial guess, in which case there's nothing to gain
+        T norm = CalcResidue(k).norm();
+        if( ! ( norm < CalcResidue(initial).norm() ) )
+                return initial;
+
+        for(size_t pass=1;pass<MaxPasses;++pass){
+                CollectionType next = k;
+                for(auto const& r : order){
+                        r->Seed(next);
+                }
+                T next_norm = CalcResidue(next).norm();
+                if( ! ( next_norm < norm ) )
+                        break;
+                k = next;
+                norm = next_norm;
+        }
+        return k;
+}
+
+template<class T>
+typename BasicKnotSolver<T>::CollectionType BasicKnotSolver<T>::Solve(CollectionType k){
+
+        const bool Debug = debug_;
 
         enum{ MaxIter = 1000 };
         for(size_t iter=0;iter < MaxIter;++iter){
@@ -23,12 +73,14 @@ KnotCollection KnotSolver::Solve(KnotCollection k){
 
                 // now we have the direction V, we want to figure out the step lengh \alpha
 
-                double alpha = 0.5;
+                // damped until every residue is within a basis point, then
+                // full Gauss-Newton steps, so a good seed converges quickly
+                T alpha = F.template lpNorm<Eigen::Infinity>() < T(1e-2) ? T(1.0) : T(0.5);
                 VectorType next = V + alpha * sol;
 
                 
 
-                RealType norm = sol.lpNorm<2>();
+                T norm = sol.template lpNorm<2>();
                 
                 if( Debug ){
                         std::cout << "J = \n" << J << "\n";
@@ -50,8 +102,8 @@ KnotCollection KnotSolver::Solve(KnotCollection k){
 
                         VectorType F_next = CalcResidue(k);
 
-                        double c_1   = 1.0;
-                        double alpha = 1.0;
+                        T c_1   = 1.0;
+                        T alpha = 1.0;
 
                         VectorType lhs = F_next - F;
                         VectorType rhs = c_1 * alpha * V.transpose() * J;
@@ -72,7 +124,7 @@ KnotCollection KnotSolver::Solve(KnotCollection k){
                 #else
                 MatrixType J = NumericalJacobian(k);
 
-                //RealType det = J.determinant();
+                //T det = J.determinant();
                 #if 1
                 MatrixType JT_J = ( J.transpose() * J );
                 MatrixType G = JT_J.inverse() * J.transpose();
@@ -85,7 +137,7 @@ KnotCollection KnotSolver::Solve(KnotCollection k){
                 using namespace Eigen;
                 JacobiSVD<MatrixType> svd(JT_J);
                 auto const& sv = svd.singularValues();
-                RealType cond = sv(0) / sv(sv.size()-1);
+                T cond = sv(0) / sv(sv.size()-1);
 
         
                 VectorType G_F = G * F;
@@ -95,7 +147,7 @@ KnotCollection KnotSolver::Solve(KnotCollection k){
 
                 VectorType d = next - V;
 
-                RealType norm = d.lpNorm<2>();
+                T norm = d.template lpNorm<2>();
                 
                 if( Debug ){
                         std::cout << "J = \n" << J << "\n";
@@ -124,3 +176,6 @@ KnotCollection KnotSolver::Solve(KnotCollection k){
         std::exit(1);
         return k;
 }
+
+template struct BasicKnotSolver<double>;
+template struct BasicKnotSolver<long double>;
@@ -3,45 +3,127 @@
 
 #include "knots.h"
 
-struct KnotSolver{
+/*
+        A point on a curve, residues report the points Calc() reads,
+        and the one point they pin down, so that knots can be placed
+        from the instrument set rather than by hand
+ */
+struct KnotPoint{
+        std::string curve;
+        Date date;
+};
+
+/*
+        T is the precision the Jacobian and linear solve are done in,
+        only double and long double are instantiated, as the numerical
+        Jacobian bump is below float precision
+ */
+template<class T>
+struct BasicKnotSolver{
+        using CollectionType = BasicKnotCollection<T>;
+        using MatrixType     = BasicMatrixType<T>;
+        using VectorType     = BasicVectorType<T>;
+
         struct Residue{
                 virtual ~Residue()=default;
-                virtual RealType Calc(KnotCollection& V, bool debug=false)const=0;
+                virtual T Calc(CollectionType& V, bool debug=false)const=0;
+                virtual KnotPoint Pillar()const=0;
+                virtual std::vector<KnotPoint> Dependencies()const=0;
+                /*
+                        Moves the knot controlling Pillar() to get Calc()
+                        close to zero, assuming the earlier pillars are
+                        already seeded. The default is a golden section
+                        search over the log of that knot, residues whose
+                        pillar is on a knot can be inverted directly, and
+                        override this
+                 */
+                virtual void Seed(CollectionType& V)const{
+                        enum{ MaxIter = 100 };
+                        const T golden = ( std::sqrt(T(5.0)) - T(1.0) ) / T(2.0);
+
+                        auto& knot = V.Curve(Pillar().curve).Controlling(Pillar().date);
+                        auto at = [&](T x){
+                                knot.value = std::exp(x);
+                                return Calc(V);
+                        };
+
+                        T lower = std::log(T(1e-3));
+                        T upper = std::log(T(2.0));
+                        T x0 = upper - golden * ( upper - lower );
+                        T x1 = lower + golden * ( upper - lower );
+                        T f0 = at(x0);
+                        T f1 = at(x1);
+                        // each iteration keeps one of the two points
+                        for(size_t iter=0;iter!=MaxIter && upper - lower > T(1e-12);++iter){
+                                if( f0 < f1 ){
+                                        upper = x1;
+                                        x1 = x0;
+                                        f1 = f0;
+                                        x0 = upper - golden * ( upper - lower );
+                                        f0 = at(x0);
+                                } else {
+                                        lower = x0;
+                                        x0 = x1;
+                                        f0 = f1;
+                                        x1 = lower + golden * ( upper - lower );
+                                        f1 = at(x1);
+                                }
+                        }
+                        knot.value = std::exp( f0 < f1 ? x0 : x1 );
+                }
         };
-        VectorType CalcResidue(KnotCollection& V)const{
+        VectorType CalcResidue(CollectionType& V)const{
                 VectorType ret(res_.size());
                 for(size_t idx=0;idx!=res_.size();++idx){
-                        ret(idx) = res_[idx]->Calc(V, true);
+                        ret(idx) = res_[idx]->Calc(V, debug_);
                 }
                 return ret;
         }
-        MatrixType NumericalJacobian(KnotCollection& V)const{
-                const RealType epsilon = 1e-10;
+        MatrixType NumericalJacobian(CollectionType& V)const{
+                const T epsilon = 1e-10;
 
                 MatrixType J(res_.size(), V.size());
                 for(size_t i=0;i!=V.size();++i){
-                        KnotCollection upper_V = V;
-                        KnotCollection lower_V = V;
+                        CollectionType upper_V = V;
+                        CollectionType lower_V = V;
                         upper_V[i].value += epsilon / 2;
                         lower_V[i].value -= epsilon / 2;
                         for(size_t j=0;j!=res_.size();++j){
-                                RealType upper = res_[j]->Calc(upper_V);
-                                RealType lower = res_[j]->Calc(lower_V);
-                                RealType calc = ( upper - lower ) / epsilon;
+                                T upper = res_[j]->Calc(upper_V);
+                                T lower = res_[j]->Calc(lower_V);
+                                T calc = ( upper - lower ) / epsilon;
                                 J(j,i) = calc;
                         }
                 }
 
                 return J;
         }
-        template<class T, class... Args>
-        KnotSolver& Add(Args&&... args){
-                res_.push_back(std::make_shared<T>(args...));
+        template<class R, class... Args>
+        BasicKnotSolver& Add(Args&&... args){
+                res_.push_back(std::make_shared<R>(args...));
                 return *this;
         }
-        KnotCollection Solve(KnotCollection k);
+        // turns off the per iteration dumps, for benchmarking
+        BasicKnotSolver& SetDebug(bool debug){
+                debug_ = debug;
+                return *this;
+        }
+        std::vector<std::shared_ptr<Residue> > const& Residues()const{
+                return res_;
+        }
+        /*
+                Initial guess for Solve(), walks the residues in pillar
+                order calling Residue::Seed(). On the first pass the knots
+                past each seeded one are set flat, as they haven't been
+                seeded yet. Pillars on different curves depend on each
+                other, so passes are repeated whilst the residue falls.
+                If seeding doesn't improve on k, k is returned as is
+         */
+        CollectionType Seed(CollectionType k)const;
+        CollectionType Solve(CollectionType k);
 private:
         std::vector<std::shared_ptr<Residue> > res_;
+        bool debug_ = true;
         /*
                 Solving essentailly works by calculating
                 a direction vector V such that
@@ -53,4 +135,6 @@ private:
         double beta_parameter_;
 };
 
+using KnotSolver = BasicKnotSolver<RealType>;
+
 #endif // KNOTS_SOLVER_H